@@ -24,6 +24,8 @@
 #include "mapping.h"
 #include "bignum.h"
 #include "pike_search.h"
+#include "threads.h"
+#include "pike_float.h"
 
 /** The empty array. */
 PMOD_EXPORT struct array empty_array=
@@ -733,6 +735,46 @@ static ptrdiff_t fast_array_search( struct array *v, const struct svalue *s,
 {
   ptrdiff_t e;
   struct svalue *ip = ITEM(v);
+
+  /* Without objects, functions and programs is_eq() just compares
+   * the values of the same type, so do that directly.
+   */
+  if (!((v->type_field | (1 << TYPEOF(*s))) &
+	(BIT_OBJECT|BIT_FUNCTION|BIT_PROGRAM))) {
+    switch(TYPEOF(*s)) {
+    case T_INT:
+      {
+	INT_TYPE i = s->u.integer;
+	if (v->type_field == BIT_INT) {
+	  for(e=start;e<v->size;e++)
+	    if(ip[e].u.integer == i)
+	      return e;
+	} else {
+	  for(e=start;e<v->size;e++)
+	    if((ip[e].u.integer == i) && (TYPEOF(ip[e]) == T_INT))
+	      return e;
+	}
+      }
+      return -1;
+    case T_FLOAT:
+      {
+	FLOAT_TYPE f = s->u.float_number;
+	for(e=start;e<v->size;e++)
+	  if((TYPEOF(ip[e]) == T_FLOAT) && (ip[e].u.float_number == f))
+	    return e;
+      }
+      return -1;
+    case T_STRING:
+      {
+	struct pike_string *str = s->u.string;
+	for(e=start;e<v->size;e++)
+	  if((ip[e].u.string == str) && (TYPEOF(ip[e]) == T_STRING))
+	    return e;
+      }
+      return -1;
+    }
+  }
+
   for(e=start;e<v->size;e++)
     if(is_eq(ip+e,s))
       return e;
@@ -1346,17 +1388,614 @@ static int alpha_int_svalue_cmpfun(const struct svalue *a, const struct svalue *
 #undef TYPE
 #undef ID
 
+/* Radix sort for arrays of only ints or only floats.
+ *
+ * The values are mapped to unsigned 64-bit keys that sort in the same
+ * order, and then sorted with a stable LSD radix sort one byte at a
+ * time, skipping the bytes where all keys are equal.
+ */
+
+/* Use the comparison sort for arrays smaller than this. */
+#define RADIX_SORT_MIN	64
+
+#define RADIX_SIGN_BIT	(((unsigned INT64)1) << 63)
+
+#if (SIZEOF_FLOAT_TYPE == 8) || (SIZEOF_FLOAT_TYPE == 4)
+#define RADIX_SORT_FLOATS
+static inline unsigned INT64 float_radix_key(FLOAT_TYPE f)
+{
+  unsigned INT64 bits;
+#if SIZEOF_FLOAT_TYPE == 8
+  memcpy(&bits, &f, sizeof(bits));
+#else
+  unsigned INT32 bits32;
+  memcpy(&bits32, &f, sizeof(bits32));
+  bits = ((unsigned INT64)bits32) << 32;
+#endif
+  /* Negative numbers sort in reverse order of their magnitude. */
+  if (bits & RADIX_SIGN_BIT) return ~bits;
+  return bits | RADIX_SIGN_BIT;
+}
+#endif
+
+/* Sort keys (and idx, if not NULL) using the temporary buffers tkeys
+ * and tidx. Returns 1 if the result ended up in the temporary buffers.
+ */
+static int low_radix_sort(unsigned INT64 *keys, INT32 *idx,
+			  unsigned INT64 *tkeys, INT32 *tidx,
+			  size_t *counts, ptrdiff_t n)
+{
+  ptrdiff_t e;
+  int pass, swapped = 0;
+
+  memset(counts, 0, 8 * 256 * sizeof(size_t));
+  for (e = 0; e < n; e++) {
+    unsigned INT64 k = keys[e];
+    for (pass = 0; pass < 8; pass++)
+      counts[pass*256 + ((k >> (pass*8)) & 0xff)]++;
+  }
+
+  for (pass = 0; pass < 8; pass++) {
+    size_t *count = counts + pass*256;
+    size_t pos = 0, c;
+    int shift = pass*8;
+    unsigned INT64 *tk;
+    INT32 *ti;
+
+    /* All keys have the same value in this byte. */
+    if (count[(keys[0] >> shift) & 0xff] == (size_t)n) continue;
+
+    for (c = 0; c < 256; c++) {
+      size_t tmp = count[c];
+      count[c] = pos;
+      pos += tmp;
+    }
+
+    if (idx) {
+      for (e = 0; e < n; e++) {
+	size_t to = count[(keys[e] >> shift) & 0xff]++;
+	tkeys[to] = keys[e];
+	tidx[to] = idx[e];
+      }
+    } else {
+      for (e = 0; e < n; e++)
+	tkeys[count[(keys[e] >> shift) & 0xff]++] = keys[e];
+    }
+
+    tk = keys; keys = tkeys; tkeys = tk;
+    ti = idx; idx = tidx; tidx = ti;
+    swapped = !swapped;
+  }
+
+  return swapped;
+}
+
+/* Sort an array of only ints or only floats destructively.
+ *
+ * If order is not NULL, the sort is stable, and order is set to the
+ * original positions of the elements (like get_alpha_order()).
+ *
+ * Returns 0 without touching the array if it isn't suitable.
+ */
+static int radix_sort_array(struct array *v, INT32 *order)
+{
+  ptrdiff_t n = v->size, e;
+  size_t keybytes;
+  unsigned INT64 *keys, *tkeys;
+  INT32 *tidx;
+  size_t *counts;
+  struct svalue *items = ITEM(v);
+  char *buf;
+
+  if (n < RADIX_SORT_MIN) return 0;
+
+  /* Room for the keys, or for a copy of the svalues when reordering. */
+  keybytes = MAXIMUM(2 * n * sizeof(unsigned INT64),
+		     n * sizeof(struct svalue));
+  buf = xalloc(keybytes + 8 * 256 * sizeof(size_t) +
+	       (order ? n * sizeof(INT32) : 0));
+  keys = (unsigned INT64 *)buf;
+  tkeys = keys + n;
+  counts = (size_t *)(buf + keybytes);
+  tidx = (INT32 *)(counts + 8 * 256);
+
+  if (v->type_field == BIT_INT) {
+    for (e = 0; e < n; e++) {
+      if (SUBTYPEOF(items[e]) != NUMBER_NUMBER) {
+	/* Keep UNDEFINED et al intact. */
+	free(buf);
+	return 0;
+      }
+      keys[e] = ((unsigned INT64)(INT64)items[e].u.integer) ^ RADIX_SIGN_BIT;
+    }
+  }
+#ifdef RADIX_SORT_FLOATS
+  else if (v->type_field == BIT_FLOAT) {
+    for (e = 0; e < n; e++) {
+      FLOAT_TYPE f = items[e].u.float_number;
+      if (PIKE_ISNAN(f)) {
+	/* NaN is unordered. */
+	free(buf);
+	return 0;
+      }
+      /* -0.0 == 0.0, so keep them in order in the stable case. */
+      if (order && (f == 0.0)) f = 0.0;
+      keys[e] = float_radix_key(f);
+    }
+  }
+#endif
+  else {
+    free(buf);
+    return 0;
+  }
+
+  if (!order) {
+    if (low_radix_sort(keys, NULL, tkeys, NULL, counts, n))
+      keys = tkeys;
+    if (v->type_field == BIT_INT) {
+      for (e = 0; e < n; e++)
+	items[e].u.integer = (INT_TYPE)(INT64)(keys[e] ^ RADIX_SIGN_BIT);
+    }
+#ifdef RADIX_SORT_FLOATS
+    else {
+      for (e = 0; e < n; e++) {
+	unsigned INT64 bits = keys[e];
+	bits = (bits & RADIX_SIGN_BIT) ? (bits & ~RADIX_SIGN_BIT) : ~bits;
+#if SIZEOF_FLOAT_TYPE == 8
+	memcpy(&items[e].u.float_number, &bits, sizeof(bits));
+#else
+	{
+	  unsigned INT32 bits32 = (unsigned INT32)(bits >> 32);
+	  memcpy(&items[e].u.float_number, &bits32, sizeof(bits32));
+	}
+#endif
+      }
+    }
+#endif
+  } else {
+    struct svalue *copy = (struct svalue *)buf;
+    for (e = 0; e < n; e++) order[e] = (INT32)e;
+    if (low_radix_sort(keys, order, tkeys, tidx, counts, n))
+      memcpy(order, tidx, n * sizeof(INT32));
+    /* The keys are no longer needed, so reuse their space. */
+    memcpy(copy, items, n * sizeof(struct svalue));
+    for (e = 0; e < n; e++)
+      items[e] = copy[order[e]];
+  }
+
+  free(buf);
+  return 1;
+}
+
+/* Multikey quicksort (Bentley & Sedgewick) for arrays of 8-bit
+ * strings. It only looks at each character of the common prefixes
+ * once, unlike a comparison sort.
+ */
+#define MKQS_CHAR(S, D)	((D) < (S)->len ? (int)STR0(S)[D] : -1)
+
+static void mkqs_strings(struct pike_string **a, ptrdiff_t n, ptrdiff_t depth)
+{
+  while (n > 1) {
+    ptrdiff_t lt, gt, i;
+    int pivot;
+
+    if (n < 16) {
+      /* Insertion sort on the rest of the strings. */
+      for (i = 1; i < n; i++) {
+	struct pike_string *s = a[i];
+	ptrdiff_t j = i;
+	while (j && (my_quick_strcmp(a[j-1], s) > 0)) {
+	  a[j] = a[j-1];
+	  j--;
+	}
+	a[j] = s;
+      }
+      return;
+    }
+
+    {
+      struct pike_string *tmp = a[0];
+      a[0] = a[n/2];
+      a[n/2] = tmp;
+    }
+    pivot = MKQS_CHAR(a[0], depth);
+
+    /* [0, lt) < pivot, [lt, gt) == pivot, [gt, n) > pivot */
+    lt = 0;
+    gt = n;
+    i = 1;
+    while (i < gt) {
+      int c = MKQS_CHAR(a[i], depth);
+      struct pike_string *tmp;
+      if (c < pivot) {
+	tmp = a[lt]; a[lt++] = a[i]; a[i++] = tmp;
+      } else if (c > pivot) {
+	tmp = a[--gt]; a[gt] = a[i]; a[i] = tmp;
+      } else {
+	i++;
+      }
+    }
+
+    {
+      /* Recurse into the smaller partitions and loop on the largest,
+       * so that the recursion depth is at most log2(n). All strings
+       * in the middle partition end here if pivot is -1, so it needs
+       * no sorting then. */
+      struct pike_string **part_a[3];
+      ptrdiff_t part_n[3], part_depth[3];
+      int p, largest = 0;
+
+      part_a[0] = a;      part_n[0] = lt;     part_depth[0] = depth;
+      part_a[1] = a + lt; part_n[1] = pivot < 0 ? 0 : gt - lt;
+      part_depth[1] = depth + 1;
+      part_a[2] = a + gt; part_n[2] = n - gt; part_depth[2] = depth;
+
+      for (p = 1; p < 3; p++)
+	if (part_n[p] > part_n[largest]) largest = p;
+      for (p = 0; p < 3; p++)
+	if (p != largest)
+	  mkqs_strings(part_a[p], part_n[p], part_depth[p]);
+
+      a = part_a[largest];
+      n = part_n[largest];
+      depth = part_depth[largest];
+    }
+  }
+}
+
+/* Sort an array of only 8-bit strings destructively.
+ *
+ * Returns 0 without touching the array if it isn't suitable.
+ */
+static int string_sort_array(struct array *v)
+{
+  ptrdiff_t n = v->size, e;
+  struct pike_string **strs;
+  struct svalue *items = ITEM(v);
+
+  if (n < RADIX_SORT_MIN) return 0;
+  for (e = 0; e < n; e++)
+    if (items[e].u.string->size_shift) return 0;
+
+  strs = xalloc(n * sizeof(struct pike_string *));
+  for (e = 0; e < n; e++) strs[e] = items[e].u.string;
+  mkqs_strings(strs, n, 0);
+  /* NB: Just a permutation, so no change of references. */
+  for (e = 0; e < n; e++) items[e].u.string = strs[e];
+  free(strs);
+  return 1;
+}
+
 /** This sort is unstable. */
 PMOD_EXPORT void sort_array_destructively(struct array *v)
 {
   if(!v->size) return;
   if (v->type_field == BIT_INT) {
-    low_sort_int_svalues(ITEM(v), ITEM(v)+v->size-1);
+    if (!radix_sort_array(v, NULL))
+      low_sort_int_svalues(ITEM(v), ITEM(v)+v->size-1);
+  } else if (((v->type_field == BIT_FLOAT) && radix_sort_array(v, NULL)) ||
+	     ((v->type_field == BIT_STRING) && string_sort_array(v))) {
+    /* Sorted. */
   } else {
     low_sort_svalues(ITEM(v), ITEM(v)+v->size-1);
   }
 }
 
+/* Unboxed sort kernels for homogeneous arrays. These only look at
+ * the keys, and can thus run without the interpreter lock.
+ */
+#define CMP(X,Y) ((*(X) < *(Y)) ? -1 : (*(X) > *(Y)))
+#define TYPE INT_TYPE
+#define ID low_sort_ints
+#include "fsort_template.h"
+#undef TYPE
+#undef ID
+
+#define TYPE FLOAT_TYPE
+#define ID low_sort_floats
+#include "fsort_template.h"
+#undef CMP
+#undef TYPE
+#undef ID
+
+#define CMP(X,Y) ((int)my_quick_strcmp(*(X), *(Y)))
+#define TYPE struct pike_string *
+#define ID low_sort_strings
+#include "fsort_template.h"
+#undef CMP
+#undef TYPE
+#undef ID
+
+#define MERGE_SORTED(NAME, TYPE, LESS)					\
+  static void NAME(TYPE *a, TYPE *ae, TYPE *b, TYPE *be, TYPE *d)	\
+  {									\
+    while ((a < ae) && (b < be)) {					\
+      if (LESS(*b, *a)) *d++ = *b++;					\
+      else *d++ = *a++;							\
+    }									\
+    while (a < ae) *d++ = *a++;						\
+    while (b < be) *d++ = *b++;						\
+  }
+
+#define NUM_LESS(X,Y) ((X) < (Y))
+#define STR_LESS(X,Y) (my_quick_strcmp((X), (Y)) < 0)
+MERGE_SORTED(merge_sorted_ints, INT_TYPE, NUM_LESS)
+MERGE_SORTED(merge_sorted_floats, FLOAT_TYPE, NUM_LESS)
+MERGE_SORTED(merge_sorted_strings, struct pike_string *, STR_LESS)
+#undef NUM_LESS
+#undef STR_LESS
+#undef MERGE_SORTED
+
+/* Don't bother with threads for less than this many elements each. */
+#define PARALLEL_SORT_MIN_CHUNK	16384
+#define PARALLEL_SORT_MAX_THREADS	256
+
+struct parallel_sort_state
+{
+  int kind;
+  int pending;
+#ifdef PIKE_THREADS
+  PIKE_MUTEX_T lock;
+  COND_T done;
+#endif
+};
+
+struct parallel_sort_job
+{
+  struct parallel_sort_state *state;
+  char *src, *dst;
+  ptrdiff_t lo, mid, hi;	/* Sort [lo, hi) if mid < 0, else merge. */
+};
+
+static void run_parallel_sort_job(struct parallel_sort_job *j)
+{
+  ptrdiff_t lo = j->lo, mid = j->mid, hi = j->hi;
+
+  switch(j->state->kind) {
+  case T_INT:
+    {
+      INT_TYPE *s = (INT_TYPE *)j->src;
+      if (mid < 0) {
+	if (hi - lo > 1) low_sort_ints(s + lo, s + hi - 1);
+      } else
+	merge_sorted_ints(s + lo, s + mid, s + mid, s + hi,
+			  (INT_TYPE *)j->dst + lo);
+    }
+    break;
+  case T_FLOAT:
+    {
+      FLOAT_TYPE *s = (FLOAT_TYPE *)j->src;
+      if (mid < 0) {
+	if (hi - lo > 1) low_sort_floats(s + lo, s + hi - 1);
+      } else
+	merge_sorted_floats(s + lo, s + mid, s + mid, s + hi,
+			    (FLOAT_TYPE *)j->dst + lo);
+    }
+    break;
+  case T_STRING:
+    {
+      struct pike_string **s = (struct pike_string **)j->src;
+      if (mid < 0) {
+	if (hi - lo > 1) low_sort_strings(s + lo, s + hi - 1);
+      } else
+	merge_sorted_strings(s + lo, s + mid, s + mid, s + hi,
+			     (struct pike_string **)j->dst + lo);
+    }
+    break;
+  }
+}
+
+#ifdef PIKE_THREADS
+static void parallel_sort_worker(void *job)
+{
+  struct parallel_sort_job *j = job;
+  struct parallel_sort_state *state = j->state;
+
+  run_parallel_sort_job(j);
+
+  mt_lock(&state->lock);
+  if (!--state->pending) co_signal(&state->done);
+  mt_unlock(&state->lock);
+}
+#endif
+
+/* Run the jobs, the first one in the current thread and the rest in
+ * the thread farm, and wait for all of them to finish.
+ *
+ * NB: Called without the interpreter lock.
+ */
+static void run_parallel_sort_jobs(struct parallel_sort_state *state,
+				   struct parallel_sort_job *jobs, int num)
+{
+#ifdef PIKE_THREADS
+  if (num > 1) {
+    int e;
+    state->pending = num - 1;
+    for (e = 1; e < num; e++)
+      th_farm(parallel_sort_worker, jobs + e);
+    run_parallel_sort_job(jobs);
+    mt_lock(&state->lock);
+    while (state->pending) co_wait(&state->done, &state->lock);
+    mt_unlock(&state->lock);
+    return;
+  }
+#endif
+  if (num) run_parallel_sort_job(jobs);
+}
+
+static int get_cpu_count(void)
+{
+#if defined(HAVE_SYSCONF) && defined(_SC_NPROCESSORS_ONLN)
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  if (n > 0) return (int)MINIMUM(n, PARALLEL_SORT_MAX_THREADS);
+#elif defined(HAVE_GETSYSTEMINFO)
+  SYSTEM_INFO sysinfo;
+  GetSystemInfo(&sysinfo);
+  if (sysinfo.dwNumberOfProcessors > 0)
+    return (int)MINIMUM(sysinfo.dwNumberOfProcessors,
+			PARALLEL_SORT_MAX_THREADS);
+#endif
+  return 1;
+}
+
+/** Sort an array of only ints, only floats or only strings
+ * destructively, using up to max_threads threads (or one per cpu if
+ * max_threads is zero or negative).
+ *
+ * The keys are copied out of the array and sorted in chunks without
+ * the interpreter lock, followed by merge passes that are also done
+ * in parallel.
+ *
+ * This sort is unstable. Returns 0 without touching the array if it
+ * contains other types, or integers with a subtype (eg UNDEFINED).
+ */
+PMOD_EXPORT int parallel_sort_array_destructively(struct array *v,
+						  int max_threads)
+{
+  struct parallel_sort_state state;
+  struct parallel_sort_job *jobs;
+  ptrdiff_t *bounds;
+  ptrdiff_t n = v->size, e;
+  size_t esize;
+  char *keys, *src, *dst;
+  int num, runs;
+  TYPE_FIELD type_field;
+
+  array_fix_unfinished_type_field(v);
+  type_field = v->type_field;
+  switch(type_field) {
+  case BIT_INT:
+    state.kind = T_INT;
+    esize = sizeof(INT_TYPE);
+    break;
+  case BIT_FLOAT:
+    state.kind = T_FLOAT;
+    esize = sizeof(FLOAT_TYPE);
+    break;
+  case BIT_STRING:
+    state.kind = T_STRING;
+    esize = sizeof(struct pike_string *);
+    break;
+  default:
+    return 0;
+  }
+  if (n < 2) return 1;
+
+  if (max_threads <= 0) max_threads = get_cpu_count();
+  num = (int)MINIMUM(max_threads, PARALLEL_SORT_MAX_THREADS);
+  if (num > n / PARALLEL_SORT_MIN_CHUNK)
+    num = (int)(n / PARALLEL_SORT_MIN_CHUNK);
+  if (num < 1) num = 1;
+#ifndef PIKE_THREADS
+  num = 1;
+#endif
+
+  keys = xalloc(2 * n * esize + num * sizeof(struct parallel_sort_job) +
+		(num + 1) * sizeof(ptrdiff_t));
+  jobs = (struct parallel_sort_job *)(keys + 2 * n * esize);
+  bounds = (ptrdiff_t *)(jobs + num);
+
+  switch(state.kind) {
+  case T_INT:
+    for (e = 0; e < n; e++) {
+      if (SUBTYPEOF(ITEM(v)[e]) != NUMBER_NUMBER) {
+	/* Keep UNDEFINED et al intact. */
+	free(keys);
+	return 0;
+      }
+      ((INT_TYPE *)keys)[e] = ITEM(v)[e].u.integer;
+    }
+    break;
+  case T_FLOAT:
+    for (e = 0; e < n; e++)
+      ((FLOAT_TYPE *)keys)[e] = ITEM(v)[e].u.float_number;
+    break;
+  case T_STRING:
+    /* Other threads may modify the array while we're sorting. */
+    for (e = 0; e < n; e++)
+      add_ref(((struct pike_string **)keys)[e] = ITEM(v)[e].u.string);
+    break;
+  }
+
+#ifdef PIKE_THREADS
+  if (num > 1) {
+    mt_init(&state.lock);
+    co_init(&state.done);
+  }
+#endif
+
+  THREADS_ALLOW();
+
+  src = keys;
+  dst = keys + n * esize;
+
+  for (e = 0; e < num; e++) {
+    bounds[e] = (n * e) / num;
+    jobs[e].state = &state;
+    jobs[e].src = src;
+    jobs[e].lo = bounds[e];
+    jobs[e].mid = -1;
+    jobs[e].hi = (n * (e + 1)) / num;
+  }
+  bounds[num] = n;
+  run_parallel_sort_jobs(&state, jobs, num);
+
+  /* Merge pairs of sorted runs until there is only one left. */
+  for (runs = num; runs > 1; runs = (runs + 1) / 2) {
+    char *tmp;
+    int pairs = runs / 2;
+    for (e = 0; e < pairs; e++) {
+      jobs[e].src = src;
+      jobs[e].dst = dst;
+      jobs[e].lo = bounds[2 * e];
+      jobs[e].mid = bounds[2 * e + 1];
+      jobs[e].hi = bounds[2 * e + 2];
+    }
+    if (runs & 1)
+      memcpy(dst + bounds[runs - 1] * esize, src + bounds[runs - 1] * esize,
+	     (n - bounds[runs - 1]) * esize);
+    run_parallel_sort_jobs(&state, jobs, pairs);
+    for (e = 0; e < (runs + 1) / 2; e++)
+      bounds[e] = bounds[2 * e];
+    bounds[e] = n;
+    tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+
+  THREADS_DISALLOW();
+
+#ifdef PIKE_THREADS
+  if (num > 1) {
+    co_destroy(&state.done);
+    mt_destroy(&state.lock);
+  }
+#endif
+
+  /* NB: The array can't have been resized, since we hold a reference
+   *     to it, but the elements might have been changed.
+   */
+  for (e = 0; e < n; e++) {
+    struct svalue *item = ITEM(v) + e;
+    free_svalue(item);
+    switch(state.kind) {
+    case T_INT:
+      SET_SVAL(*item, T_INT, NUMBER_NUMBER, integer, ((INT_TYPE *)src)[e]);
+      break;
+    case T_FLOAT:
+      SET_SVAL(*item, T_FLOAT, 0, float_number, ((FLOAT_TYPE *)src)[e]);
+      break;
+    case T_STRING:
+      SET_SVAL(*item, T_STRING, 0, string, ((struct pike_string **)src)[e]);
+      break;
+    }
+  }
+  v->type_field = type_field;
+
+  free(keys);
+  return 1;
+}
+
 #define SORT_BY_INDEX
 #define EXTRA_LOCALS int cmpfun_res;
 #define CMP(X,Y) ((cmpfun_res =						\
@@ -1394,6 +2033,14 @@ PMOD_EXPORT INT32 *stable_sort_array_destructively(struct array *v)
   /* Overflow safe: ((1<<29)-4)*4 < ULONG_MAX */
   current_order=xalloc(v->size * sizeof(INT32));
   SET_ONERROR(tmp, free, current_order);
+
+  array_fix_unfinished_type_field(v);
+  if (((v->type_field == BIT_INT) || (v->type_field == BIT_FLOAT)) &&
+      radix_sort_array(v, current_order)) {
+    UNSET_ONERROR(tmp);
+    return current_order;
+  }
+
   for(e=0; e<v->size; e++) current_order[e]=e;
 
   low_stable_sort_svalues (0, v->size - 1, ITEM (v), current_order, v->size);
@@ -1934,6 +2581,29 @@ PMOD_EXPORT int array_equal_p(struct array *a, struct array *b, struct processin
      !( (a->type_field | b->type_field) & (BIT_OBJECT|BIT_FUNCTION) ))
     return 0;
 
+  /* Arrays of only ints, only floats or only strings can be
+   * compared without recursing through low_is_equal().
+   */
+  if (a->type_field == b->type_field) {
+    switch(a->type_field) {
+    case BIT_INT:
+      for(e=0; e<a->size; e++)
+	if(ITEM(a)[e].u.integer != ITEM(b)[e].u.integer)
+	  return 0;
+      return 1;
+    case BIT_FLOAT:
+      for(e=0; e<a->size; e++)
+	if(ITEM(a)[e].u.float_number != ITEM(b)[e].u.float_number)
+	  return 0;
+      return 1;
+    case BIT_STRING:
+      for(e=0; e<a->size; e++)
+	if(ITEM(a)[e].u.string != ITEM(b)[e].u.string)
+	  return 0;
+      return 1;
+    }
+  }
+
   curr.pointer_a = a;
   curr.pointer_b = b;
   curr.next = p;
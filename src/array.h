@@ -152,6 +152,8 @@ INT32 *get_order(struct array *v, cmpfun fun);
 int set_svalue_cmpfun(const struct svalue *a, const struct svalue *b);
 int alpha_svalue_cmpfun(const struct svalue *a, const struct svalue *b);
 PMOD_EXPORT void sort_array_destructively(struct array *v);
+PMOD_EXPORT int parallel_sort_array_destructively(struct array *v,
+						  int max_threads);
 PMOD_EXPORT INT32 *stable_sort_array_destructively(struct array *v);
 PMOD_EXPORT INT32 *get_set_order(struct array *a);
 PMOD_EXPORT INT32 *get_switch_order(struct array *a);
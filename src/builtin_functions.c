@@ -5772,6 +5772,51 @@ PMOD_EXPORT void f_sort(INT32 args)
   }
 }
 
+/*! @module Array
+ */
+
+/*! @decl array parallel_sort(array index, void|int(1..) max_threads)
+ *!
+ *!   Sort an array destructively, using several threads.
+ *!
+ *!   Arrays that contain only integers, only floats or only strings
+ *!   are sorted without holding the interpreter lock, split over up
+ *!   to @[max_threads] threads (default one per cpu). Small arrays
+ *!   are sorted in the current thread.
+ *!
+ *!   Any other array is sorted with @[sort()].
+ *!
+ *! @returns
+ *!   The first argument is returned.
+ *!
+ *! @note
+ *!   The sort order is the same as for @[sort()], but the sort is not
+ *!   stable, so it can't be used to reorder other arrays.
+ *!
+ *! @seealso
+ *!   @[sort()], @[Array.parallel_map()]
+ */
+PMOD_EXPORT void f_parallel_sort(INT32 args)
+{
+  struct array *a;
+  INT_TYPE max_threads = 0;
+
+  get_all_args("parallel_sort", args, "%a.%i", &a, &max_threads);
+  if ((args > 1) && (max_threads < 1))
+    SIMPLE_ARG_TYPE_ERROR("parallel_sort", 2, "int(1..)");
+
+  if (parallel_sort_array_destructively(a, (int)MINIMUM(max_threads, 256))) {
+    /* Sorted. */
+  } else if (a->type_field & BIT_COMPLEX)
+    free(stable_sort_array_destructively(a));
+  else
+    sort_array_destructively(a);
+  pop_n_elems(args-1);
+}
+
+/*! @endmodule
+ */
+
 /*! @decl array rows(mixed data, array index)
  *!
  *!   Select a set of rows from an array.
@@ -10505,6 +10550,11 @@ void init_builtin_efuns(void)
 	   tFuncV(tArr(tSetvar(0,tMix)),tArr(tMix),tArr(tVar(0))),
 	   OPT_SIDE_EFFECT);
 
+  /* function(array(0=mixed),int|void:array(0)) */
+  ADD_FUNCTION2("parallel_sort",f_parallel_sort,
+		tFunc(tArr(tSetvar(0,tMix)) tOr(tInt1Plus,tVoid),
+		      tArr(tVar(0))), 0, OPT_SIDE_EFFECT);
+
   /* function(array(0=mixed)...:array(0)) */
   ADD_FUNCTION2("splice",f_splice,
 		tFuncV(tNone,tArr(tSetvar(0,tMix)),tArr(tVar(0))), 0,
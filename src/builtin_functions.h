@@ -119,6 +119,7 @@ TYPEP(f_multisetp, "multisetp", PIKE_T_MULTISET)
 TYPEP(f_stringp, "stringp", PIKE_T_STRING)
 TYPEP(f_floatp, "floatp", PIKE_T_FLOAT)
 PMOD_EXPORT void f_sort(INT32 args);
+PMOD_EXPORT void f_parallel_sort(INT32 args);
 PMOD_EXPORT void f_rows(INT32 args);
 PMOD_EXPORT void f__verify_internals(INT32 args);
 PMOD_EXPORT void f_gmtime(INT32 args);
@@ -182,6 +182,7 @@
   ZMEMBER(int, num_inherits, 0)	/* Used during second pass. */
   STRMEMBER(last_identifier,0)
   ZMEMBER(struct mapping *,module_index_cache,0)
+  ZMEMBER(struct mapping *,inline_functions,0)
   STACKMEMBER(struct pike_type ***,pike_type_mark_stackp,pike_type_mark_stack,pop_stack_mark())
   STACKMEMBER(struct pike_type **,type_stackp,type_stack,compiler_discard_top_type())
   ZMEMBER(INT32,parent_identifier,0)
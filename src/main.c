@@ -594,6 +594,13 @@ int main(int argc, char **argv)
 	    l_flag++,p++;
 	  break;
 
+	case 'O':
+	  if(p[1]>='0' && p[1]<='9')
+	    o_flag=strtol(p+1,&p,10);
+	  else
+	    o_flag++,p++;
+	  break;
+
 	default:
 	  p+=strlen(p);
 	}
@@ -20,6 +20,7 @@
 #include "math_module.h"
 
 #include "bignum.h"
+#include "threads.h"
 
 #ifdef HAVE_MPI_H
 #include <mpi.h>
@@ -42,6 +43,12 @@ extern struct program *math_imatrix_program;
 extern struct program *math_fmatrix_program;
 extern struct program *math_lmatrix_program;
 
+/* Block size (in elements) for the matrix multiplication loops, and
+ * the number of multiply-adds above which the interpreter lock is
+ * released during a multiplication. */
+#define MATRIX_MULT_BLOCK 64
+#define MATRIX_MULT_THREADS_LIMIT 262144
+
 #ifdef HAS_MPI
 struct size_info {
     int x, y;
@@ -248,7 +255,9 @@ extern PMOD_EXPORT struct object *mpi_ex_op(struct op_info (*create)(void *),
 /*! @decl Matrix `*(object with)
  *! @decl Matrix ``*(object with)
  *! @decl Matrix mult(object with)
- *!	Matrix multiplication.
+ *!	Matrix multiplication. The number of columns in this matrix
+ *!	must equal the number of rows in @[with]; the result has as
+ *!	many rows as this matrix and as many columns as @[with].
  */
 
 /*! @decl Matrix cross(object with)
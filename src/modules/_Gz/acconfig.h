@@ -13,4 +13,7 @@
 /* Define this if you have -lz */
 #undef HAVE_LIBZ
 
+/* Define if zlib has crc32_combine(). */
+#undef HAVE_CRC32_COMBINE
+
 #endif
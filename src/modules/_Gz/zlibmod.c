@@ -1177,14 +1177,45 @@ static void gz_crc32(INT32 args)
    } else
       crc=0;
 
-   crc=crc32(crc,
-	     (unsigned char*)sp[-args].u.string->str,
-             (unsigned INT32)(sp[-args].u.string->len));
+   {
+     unsigned char *str = (unsigned char*)sp[-args].u.string->str;
+     unsigned INT32 len = (unsigned INT32)(sp[-args].u.string->len);
+     /* Let other threads run while checksumming large strings. */
+     if (len >= 65536) {
+       THREADS_ALLOW();
+       crc=crc32(crc, str, len);
+       THREADS_DISALLOW();
+     } else
+       crc=crc32(crc, str, len);
+   }
 
    pop_n_elems(args);
    push_int64((INT64)crc);
 }
 
+#ifdef HAVE_CRC32_COMBINE
+/*! @decl int crc32_combine(int(0..) crc1, int(0..) crc2, int(0..) len2)
+ *!
+ *!   Combine two checksums calculated with @[crc32()].
+ *!
+ *! @returns
+ *!   Returns the checksum of the concatenation of two strings, where
+ *!   @[crc1] is the checksum of the first string, and @[crc2] and
+ *!   @[len2] are the checksum and length of the second string.
+ *!
+ *! @note
+ *!   Not available in all zlib versions.
+ */
+static void gz_crc32_combine(INT32 args)
+{
+  INT_TYPE crc1, crc2, len2;
+  get_all_args(NULL, args, "%+%+%+", &crc1, &crc2, &len2);
+  crc1 = crc32_combine((uLong)crc1, (uLong)crc2, (z_off_t)len2);
+  pop_n_elems(args);
+  push_int64((INT64)(unsigned INT32)crc1);
+}
+#endif
+
 /*! @decl int adler32(string(8bit) data, void|int(0..) start_value)
  *!
  *!   This function calculates the Adler-32 Cyclic Redundancy Check.
@@ -1365,6 +1396,10 @@ PIKE_MODULE_INIT
   /* function(string(8bit),void|int:int) */
   ADD_FUNCTION("crc32",gz_crc32,tFunc(tStr8 tOr(tVoid,tIntPos),tIntPos),0);
   ADD_FUNCTION("adler32",gz_adler32,tFunc(tStr8 tOr(tVoid,tIntPos),tIntPos),0);
+#ifdef HAVE_CRC32_COMBINE
+  ADD_FUNCTION("crc32_combine",gz_crc32_combine,
+	       tFunc(tIntPos tIntPos tIntPos,tIntPos),0);
+#endif
 
   /* function(string(8bit)|String.Buffer|System.Memory|Stdio.Buffer,void|int(0..1),void|int,void|int:string(8bit)) */
   ADD_FUNCTION("compress",gz_compress,tFunc(tOr(tStr8,tObj) tOr(tVoid,tInt01) tOr(tVoid,tInt09) tOr(tVoid,tInt) tOr(tVoid,tInt),tStr8),0);
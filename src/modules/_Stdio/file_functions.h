@@ -48,6 +48,15 @@ FILE_FUNC("set_nodelay", file_nodelay,
 FILE_FUNC("sync", file_sync, tFunc(tNone,tInt))
 #endif /* HAVE_FSYNC */
 
+#ifdef HAVE_PREAD
+/* function(int(0..),int(0..):string(8bit)) */
+FILE_FUNC("pread", file_pread, tFunc(tIntPos tIntPos, tStr8))
+#endif /* HAVE_PREAD */
+#ifdef HAVE_PWRITE
+/* function(string(8bit),int(0..):int) */
+FILE_FUNC("pwrite", file_pwrite, tFunc(tStr8 tIntPos, tInt))
+#endif /* HAVE_PWRITE */
+
 /* function(int,int|void,int|void:int) */
 FILE_FUNC("seek",file_seek,
           tOr(tFunc(tInt tOr(tNStr(tInt05),tVoid),tInt),
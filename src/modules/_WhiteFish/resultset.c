@@ -543,26 +543,71 @@ static void f_resultset_or( INT32 args )
   wf_resultset_push( res );
 }
 
+/* Returns the index of the first entry at or after from whose
+ * doc_id is at least doc, or size if there is none. Searches with
+ * exponentially increasing steps, so that skipping far ahead in a
+ * large set is cheap.
+ */
+static inline int gallop_to( struct hits *hits, int from, int size,
+			     unsigned INT32 doc )
+{
+  int lo = from, hi, step = 1;
+
+  if( lo >= size || hits[lo].doc_id >= doc )
+    return lo;
+
+  /* hits[lo].doc_id < doc */
+  while( lo + step < size && hits[lo+step].doc_id < doc )
+  {
+    lo += step;
+    step <<= 1;
+  }
+  hi = lo + step < size ? lo + step : size;
+
+  /* hits[lo].doc_id < doc <= hits[hi].doc_id */
+  while( hi - lo > 1 )
+  {
+    int mid = lo + ((hi - lo) >> 1);
+    if( hits[mid].doc_id < doc )
+      lo = mid;
+    else
+      hi = mid;
+  }
+  return hi;
+}
+
+/* Make room for size entries in the set o, and empty it. */
+static ResultSet *wf_resultset_alloc( struct object *o, int size )
+{
+  if( T(o)->d ) free( T(o)->d );
+  T(o)->allocated_size = size;
+  T(o)->d = xalloc( 4 + 8*size );
+  T(o)->d->num_docs = 0;
+  return T(o)->d;
+}
+
+/* Use galloping instead of merging when one set is at least this many
+ * times larger than the other. */
+#define GALLOP_RATIO 16
+
 static void f_resultset_intersect( INT32 args )
 /*! @decl ResultSet intersect( ResultSet a )
  *! @decl ResultSet `&( ResultSet a )
  *!
  *! Return a new resultset with all entries that are present in _both_
  *! sets. Only the document_id is checked, the resulting ranking is
- *! the sum of the rankings if the two sets.
+ *! the minimum of the rankings in the two sets.
+ *!
+ *! When one set is much smaller than the other, only the entries in
+ *! the larger set near the ones in the smaller set are examined.
  */
 {
   struct object *res = wf_resultset_new();
   struct object *left = Pike_fp->current_object;
   struct object *right;
-  int lp=-1, rp=-1;
-
-  int left_valid = 0, right_valid = 0;
-  int left_left=1, right_left=1;
-  int right_size, left_size;
-
-  int left_doc=0, left_rank=0, right_doc=0, right_rank=2147483647, last=-1;
-  ResultSet *set_r, *set_l = T(left)->d;
+  int lp = 0, rp = 0, left_size, right_size;
+  ResultSet *set_r, *set_l = T(left)->d, *out;
+  struct hits *l, *r, *o;
 
   get_all_args( NULL, args, "%o", &right );
 
@@ -577,55 +622,57 @@ static void f_resultset_intersect( INT32 args )
     return;
   }
 
-  left_left = !!(left_size = set_l->num_docs);
-  right_left = !!(right_size = set_r->num_docs);
+  left_size = set_l->num_docs;
+  right_size = set_r->num_docs;
+  l = set_l->hits;
+  r = set_r->hits;
+
+  out = wf_resultset_alloc( res, MINIMUM(left_size, right_size) );
+  o = out->hits;
 
-  while( left_left && right_left )
+  if( left_size > right_size * GALLOP_RATIO ||
+      right_size > left_size * GALLOP_RATIO )
   {
-    if( !left_valid ) /* New from left */
+    struct hits *small = l, *big = r;
+    int small_size = left_size, big_size = right_size, bp = 0, si;
+    if( left_size > right_size )
     {
-      if( ++lp >= left_size )
-      {
-	left_left = 0;
-	break;
-      }
-      else
-      {
-	left_doc = set_l->hits[lp].doc_id;
-	left_rank = set_l->hits[lp].ranking;
-	left_valid = 1;
-      }
+      small = r; big = l;
+      small_size = right_size; big_size = left_size;
     }
-
-    if( !right_valid ) /* New from right */
+    for( si = 0; si < small_size && bp < big_size; si++ )
     {
-      if( ++rp >= right_size )
+      bp = gallop_to( big, bp, big_size, small[si].doc_id );
+      if( bp < big_size && big[bp].doc_id == small[si].doc_id )
       {
-	right_left = 0;
-	break;
+	o->doc_id = small[si].doc_id;
+	o->ranking = MINIMUM(small[si].ranking, big[bp].ranking);
+	o++;
+	bp++;
       }
+    }
+  }
+  else
+  {
+    while( lp < left_size && rp < right_size )
+    {
+      unsigned INT32 left_doc = l[lp].doc_id, right_doc = r[rp].doc_id;
+      if( left_doc < right_doc )
+	lp++;
+      else if( right_doc < left_doc )
+	rp++;
       else
       {
-	right_doc = set_r->hits[rp].doc_id;
-	right_rank = set_r->hits[rp].ranking;
-	right_valid = 1;
+	o->doc_id = left_doc;
+	o->ranking = MINIMUM(l[lp].ranking, r[rp].ranking);
+	o++;
+	lp++;
+	rp++;
       }
     }
-
-    if (left_doc < right_doc) {
-      left_valid = 0;
-      continue;
-    }
-
-    if (right_doc < left_doc) {
-      right_valid = 0;
-      continue;
-    }
-
-    if (right_rank < left_rank) left_rank = right_rank;
-    wf_resultset_add(res, left_doc, left_rank);
-    left_valid = right_valid = 0;
   }
+  out->num_docs = o - out->hits;
+
   pop_n_elems( args );
   wf_resultset_push( res );
 }
@@ -737,14 +784,9 @@ static void f_resultset_sub( INT32 args )
   struct object *res = wf_resultset_new();
   struct object *left = Pike_fp->current_object;
   struct object *right;
-  int lp=-1, rp=-1;
-
-  int left_used=1, right_used=1;
-  int left_left=1, right_left=1;
-  int right_size, left_size;
-
-  int left_doc=0, left_rank=0, right_doc=0, last=-1;
-  ResultSet *set_r, *set_l = T(left)->d;
+  int lp, rp = 0, left_size, right_size;
+  ResultSet *set_r, *set_l = T(left)->d, *out;
+  struct hits *l, *r, *o;
 
   get_all_args( NULL, args, "%o", &right );
 
@@ -752,7 +794,7 @@ static void f_resultset_sub( INT32 args )
   set_r = T(right)->d;
 
 
-  if( !set_l  ) /* ({}) - X == ({}) */
+  if( !set_l || !set_l->num_docs ) /* ({}) - X == ({}) */
   {
     pop_n_elems(args);
     wf_resultset_push(res);
@@ -769,51 +811,32 @@ static void f_resultset_sub( INT32 args )
 
   left_size = set_l->num_docs;
   right_size = set_r->num_docs;
+  l = set_l->hits;
+  r = set_r->hits;
 
-  while( left_left )
-  {
-    if( left_left && left_used ) /* New from left */
-    {
-      if( ++lp == left_size )
-      {
-	left_left = 0;
-	break;
-      }
-      else
-      {
-	left_doc = set_l->hits[lp].doc_id;
-	left_rank = set_l->hits[lp].ranking;
-	left_used = 0;
-      }
-    }
+  out = wf_resultset_alloc( res, left_size );
+  o = out->hits;
 
-    if( right_left && right_used ) /* New from right */
-    {
-      if( ++rp == right_size )
-      {
-	right_left = 0;
-      }
-      else
-      {
-	right_doc = set_r->hits[rp].doc_id;
-	right_used = 0;
-      }
-    }
+  for( lp = 0; lp < left_size; lp++ )
+  {
+    unsigned INT32 left_doc = l[lp].doc_id;
 
+    /* Skip duplicates. */
+    if( o > out->hits && left_doc <= o[-1].doc_id )
+      continue;
 
-    if(!right_left || (left_doc <= right_doc))
-    {
-      if( left_doc != right_doc )
-      {
-	if(left_doc>last)
-	  wf_resultset_add( res, (last = left_doc), left_rank );
-      }
-      left_used=1;
-    }
+    if( right_size > left_size * GALLOP_RATIO )
+      rp = gallop_to( r, rp, right_size, left_doc );
+    else
+      while( rp < right_size && r[rp].doc_id < left_doc )
+	rp++;
 
-    if( right_doc <= left_doc )
-      right_used=1;
+    if( rp < right_size && r[rp].doc_id == left_doc )
+      continue;
+    *o++ = l[lp];
   }
+  out->num_docs = o - out->hits;
+
   pop_n_elems( args );
   wf_resultset_push( res );
 }
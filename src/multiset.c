@@ -1109,9 +1109,43 @@ static struct multiset *mkmultiset_2 (struct array *indices,
     int pos, size = indices->size;
     ONERROR uwp;
 
+    new.msd->ind_types = indices->type_field;
     new.list = NULL;
+    new.node = NULL;
     SET_ONERROR (uwp, free_tree_build_data, &new);
-    new.msd->ind_types = indices->type_field;
+
+    /* If the indices already are in order then the nodes can be laid
+     * out in sequence and knit together to a balanced tree in linear
+     * time. This is only done for types that neither can be destructed
+     * nor have comparison lfuns, so the comparisons can't throw. */
+    if ((!cmp_less || TYPEOF(*cmp_less) == T_INT) &&
+	!(indices->type_field & ~(BIT_INT|BIT_FLOAT|BIT_STRING))) {
+      for (pos = 1; pos < size; pos++) {
+	int cmp_res;
+	INTERNAL_CMP (&ITEM (indices)[pos - 1], &ITEM (indices)[pos],
+		      cmp_res);
+	/* Note: CMPFUN_UNORDERED > 0 - not in order. */
+	if (cmp_res > 0) break;
+      }
+
+      if (pos == size) {
+	struct msnode_ind *node;
+	for (pos = 0; pos < size; pos++) {
+	  node = NODE_AT (new.msd, msnode_ind, pos);
+	  assign_svalue_no_free (&node->ind, &ITEM (indices)[pos]);
+#ifdef PIKE_DEBUG
+	  SET_SVAL_TYPE(node->ind, TYPEOF(node->ind) | MULTISET_FLAG_MARKER);
+#endif
+	  node->next = pos + 1 < size ?
+	    NODE_AT (new.msd, msnode_ind, pos + 1) : NULL;
+	}
+	new.msd->size = size;
+	new.msd->root = RBNODE (rb_make_tree (HDR (new.msd->nodes), size));
+	UNSET_ONERROR (uwp);
+	fix_free_list (new.msd, size);
+	goto done;
+      }
+    }
 
     for (pos = 0; pos < size; pos++) {
       new.node = INODE (NODE_AT (new.msd, msnode_ind, pos));
@@ -1168,6 +1202,7 @@ static struct multiset *mkmultiset_2 (struct array *indices,
     fix_free_list (new.msd, indices->size);
   }
 
+done:
   l = ba_alloc(&multiset_allocator);
   l->msd = new.msd;
   add_ref (new.msd);
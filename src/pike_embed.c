@@ -87,6 +87,7 @@ PMOD_EXPORT int default_t_flag=0;
 PMOD_EXPORT int a_flag=0;
 PMOD_EXPORT int l_flag=0;
 PMOD_EXPORT int p_flag=0;
+PMOD_EXPORT int o_flag=1;
 
 int set_pike_debug_options(int bits, int mask)
 {
@@ -25,6 +25,7 @@
 #include "bignum.h"
 #include "module_support.h"
 #include "sprintf.h"
+#include "sscanf.h"
 #include "pike_search.h"
 
 #include "modules/modlist_headers.h"
@@ -116,6 +117,7 @@ static void exit_builtin_modules(void)
   /* Clear various global references. */
 
   exit_sprintf();
+  exit_sscanf();
   exit_pike_searching();
   exit_object();
   exit_signals();
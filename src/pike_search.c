@@ -16,6 +16,12 @@
 #include "module_support.h"
 #include "pike_macros.h"
 #include "pike_search.h"
+#include "bitvector.h"
+
+#if defined(__GNUC__) && defined(__SSE2__) && defined(HAVE_EMMINTRIN_H)
+#include <emmintrin.h>
+#define SSE2_SEARCH
+#endif
 
 ptrdiff_t pike_search_struct_offset;
 #define OB2MSEARCH(O) ((struct pike_mem_searcher *)((O)->storage+pike_search_struct_offset))
@@ -55,6 +61,57 @@ static const struct SearchMojtVtable nil_search_vtable = {
   (SearchMojtFuncN) nil_searchN,
 };
 
+#ifdef SSE2_SEARCH
+/* Generic SIMD substring search for 8-bit needles in 8-bit haystacks.
+ *
+ * The first and last characters of the needle are compared against
+ * 16 consecutive positions in the haystack at a time, and a full
+ * comparison is only done where both of them match. This is much
+ * faster than memchr() followed by memcmp() for common first
+ * characters, and faster than Boyer-Moore for short needles.
+ *
+ * needlelen must be at least 2.
+ */
+static p_wchar0 *sse2_memmem0(const p_wchar0 *needle, ptrdiff_t needlelen,
+			      const p_wchar0 *haystack, ptrdiff_t haystacklen)
+{
+  __m128i first, last;
+  ptrdiff_t i, end;
+
+  if (needlelen > haystacklen) return NULL;
+
+  /* Number of possible start positions. */
+  end = haystacklen - needlelen + 1;
+
+  first = _mm_set1_epi8((char)needle[0]);
+  last = _mm_set1_epi8((char)needle[needlelen-1]);
+
+  for (i = 0; i + 16 <= end; i += 16) {
+    __m128i f = _mm_loadu_si128((const __m128i *)(haystack + i));
+    __m128i l = _mm_loadu_si128((const __m128i *)(haystack + i +
+						  needlelen - 1));
+    unsigned INT32 mask =
+      _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, f),
+				      _mm_cmpeq_epi8(last, l)));
+    while (mask) {
+      ptrdiff_t pos = i + ctz32(mask);
+      if (!memcmp(haystack + pos + 1, needle + 1, needlelen - 2))
+	return (p_wchar0 *)haystack + pos;
+      mask &= mask - 1;
+    }
+  }
+
+  for (; i < end; i++) {
+    if ((haystack[i] == needle[0]) &&
+	(haystack[i + needlelen - 1] == needle[needlelen - 1]) &&
+	!memcmp(haystack + i + 1, needle + 1, needlelen - 2))
+      return (p_wchar0 *)haystack + i;
+  }
+
+  return NULL;
+}
+#endif /* SSE2_SEARCH */
+
 /* magic stuff for hubbesearch */
 /* NOTE: GENERIC_GET4_CHARS(PTR) must be compatible with
  *       the GET_4_{,UN}ALIGNED_CHARS0() variants!
@@ -54,6 +54,9 @@ inline HCHAR *NameNH(memchr_memcmp)(NCHAR *needle,
 				    HCHAR *haystack,
 				    ptrdiff_t haystacklen)
 {
+#if defined(SSE2_SEARCH) && NSHIFT == 0 && HSHIFT == 0
+  return sse2_memmem0(needle, needlelen, haystack, haystacklen);
+#else
   NCHAR c;
   HCHAR *end;
 
@@ -68,6 +71,7 @@ inline HCHAR *NameNH(memchr_memcmp)(NCHAR *needle,
       return haystack-1;
 
   return 0;
+#endif
 }
 
 
@@ -94,6 +98,14 @@ HCHAR *NameNH(boyer_moore_hubbe)(struct boyer_moore_hubbe_searcher *s,
 				 HCHAR *haystack,
 				 ptrdiff_t haystacklen)
 {
+#if defined(SSE2_SEARCH) && NSHIFT == 0 && HSHIFT == 0
+  /* The SIMD filter beats the skip table for 8-bit haystacks, for
+   * all needle lengths that end up here (see init_memsearch()). The
+   * table is still built, since the same searcher is used for wide
+   * haystacks too.
+   */
+  return sse2_memmem0(NEEDLE, NEEDLELEN, haystack, haystacklen);
+#else
   NCHAR *needle = NEEDLE;
   ptrdiff_t nlen = NEEDLELEN;
   ptrdiff_t plen = s->plen;
@@ -153,6 +165,7 @@ HCHAR *NameNH(boyer_moore_hubbe)(struct boyer_moore_hubbe_searcher *s,
     }
   }
   return 0;
+#endif
 }
 
 
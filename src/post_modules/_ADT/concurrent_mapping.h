@@ -0,0 +1,2 @@
+void pike_init_ConcurrentMapping_module(void);
+void pike_exit_ConcurrentMapping_module(void);
@@ -0,0 +1,2 @@
+void pike_init_LRUCache_module(void);
+void pike_exit_LRUCache_module(void);
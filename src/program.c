@@ -4341,6 +4341,12 @@ static void toss_compilation_resources(void)
     Pike_compiler->module_index_cache=0;
   }
 
+  if(Pike_compiler->inline_functions)
+  {
+    free_mapping(Pike_compiler->inline_functions);
+    Pike_compiler->inline_functions=0;
+  }
+
   while(Pike_compiler->compiler_frame)
     pop_compiler_frame();
 
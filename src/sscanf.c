@@ -1533,6 +1533,268 @@ MK_VERY_LOW_SSCANF(1,2)
 MK_VERY_LOW_SSCANF(2,2)
 
 
+/* Compiled formats.
+ *
+ * The vast majority of formats are constant strings that only consist
+ * of literal text and plain %s, %d, %c and %f directives (optionally
+ * with the * modifier), eg "%s %d [%s] \"%s\"". Such formats are
+ * compiled once into a short list of operations, where the end marker
+ * for each %s has already been located, and are then kept in a small
+ * direct mapped cache keyed on the (shared) format string.
+ *
+ * Formats using any other feature, wide formats and wide input are
+ * handled by the generic very_low_sscanf_*() functions above.
+ */
+
+#define SSCANF_CACHE_SIZE	64	/* Must be a power of 2. */
+#define SSCANF_MAX_OPS		16
+
+enum sscanf_op_kind {
+  SSCANF_OP_LITERAL,		/* Literal text. */
+  SSCANF_OP_STRING,		/* %s at the end of the format. */
+  SSCANF_OP_STRING_TO,		/* %s followed by literal text. */
+  SSCANF_OP_INT,		/* %d */
+  SSCANF_OP_CHAR,		/* %c */
+  SSCANF_OP_FLOAT		/* %f */
+};
+
+struct sscanf_op
+{
+  enum sscanf_op_kind kind;
+  int no_assign;
+  ptrdiff_t pos, len;		/* Literal text in the format string. */
+};
+
+struct sscanf_program
+{
+  struct pike_string *format;
+  INT32 num_ops;		/* -1 if the format isn't compilable. */
+  struct sscanf_op ops[SSCANF_MAX_OPS];
+};
+
+static struct sscanf_program *sscanf_cache[SSCANF_CACHE_SIZE];
+
+static void compile_sscanf_format(struct sscanf_program *prog)
+{
+  p_wchar0 *match = STR0(prog->format);
+  ptrdiff_t match_len = prog->format->len;
+  ptrdiff_t cnt = 0;
+  INT32 num_ops = 0;
+
+  prog->num_ops = -1;
+
+  while (cnt < match_len) {
+    struct sscanf_op *op;
+
+    if (num_ops >= SSCANF_MAX_OPS) return;
+    op = prog->ops + num_ops++;
+    op->no_assign = 0;
+    op->pos = cnt;
+    op->len = 0;
+
+    if ((match[cnt] != '%') || (match[cnt+1] == '%')) {
+      /* Literal text. "%%" is split so that it ends with a single '%'. */
+      op->kind = SSCANF_OP_LITERAL;
+      while ((cnt < match_len) && (match[cnt] != '%')) cnt++;
+      if ((cnt < match_len) && (match[cnt+1] == '%')) {
+	cnt++;
+	op->len = cnt - op->pos;
+	cnt++;
+      } else {
+	op->len = cnt - op->pos;
+      }
+      continue;
+    }
+
+    cnt++;
+    if (match[cnt] == '*') {
+      op->no_assign = 1;
+      cnt++;
+    }
+    if (cnt >= match_len) return;
+
+    switch(match[cnt]) {
+    case 'd': op->kind = SSCANF_OP_INT; break;
+    case 'c': op->kind = SSCANF_OP_CHAR; break;
+    case 'f': op->kind = SSCANF_OP_FLOAT; break;
+    case 's':
+      if (cnt + 1 >= match_len) {
+	op->kind = SSCANF_OP_STRING;
+	break;
+      }
+      /* Adjacent directives and "%%" in the end marker need
+       * the full matcher.
+       */
+      if (match[cnt+1] == '%') return;
+      op->kind = SSCANF_OP_STRING_TO;
+      op->pos = ++cnt;
+      while ((cnt < match_len) && (match[cnt] != '%')) cnt++;
+      if ((cnt < match_len) && (match[cnt+1] == '%')) return;
+      op->len = cnt - op->pos;
+      continue;
+    default:
+      return;
+    }
+    cnt++;
+  }
+
+  prog->num_ops = num_ops;
+}
+
+/* Returns the compiled program for format, or NULL if it can't be
+ * handled by run_sscanf_program().
+ */
+static struct sscanf_program *get_sscanf_program(struct pike_string *format)
+{
+  struct sscanf_program **slot =
+    sscanf_cache + ((PTR_TO_INT(format) >> 5) & (SSCANF_CACHE_SIZE - 1));
+  struct sscanf_program *prog = *slot;
+
+  if (format->size_shift) return NULL;
+
+  if (!prog || (prog->format != format)) {
+    if (!prog) {
+      *slot = prog = xalloc(sizeof(struct sscanf_program));
+    } else {
+      free_string(prog->format);
+    }
+    copy_shared_string(prog->format, format);
+    compile_sscanf_format(prog);
+  }
+
+  if (prog->num_ops < 0) return NULL;
+  return prog;
+}
+
+/* Same calling convention as very_low_sscanf_0_0(). */
+static INT32 run_sscanf_program(struct sscanf_program *prog,
+				p_wchar0 *input,
+				ptrdiff_t input_len,
+				p_wchar0 *match,
+				ptrdiff_t *chars_matched,
+				struct pike_string *pstr)
+{
+  /* NB: The cache entry may get reused if we end up running Pike code
+   *     (eg when loading Gmp for a bignum), so work on a copy.
+   */
+  struct sscanf_op ops[SSCANF_MAX_OPS];
+  INT32 num_ops = prog->num_ops;
+  INT32 matches = 0, i;
+  ptrdiff_t eye = 0, e;
+
+  memcpy(ops, prog->ops, num_ops * sizeof(struct sscanf_op));
+
+  for (i = 0; i < num_ops; i++) {
+    struct sscanf_op *op = ops + i;
+    struct svalue sval;
+
+    switch(op->kind) {
+    case SSCANF_OP_LITERAL:
+      for (e = op->pos; e < op->pos + op->len; e++, eye++) {
+	if ((eye >= input_len) || (input[eye] != match[e])) {
+	  chars_matched[0] = eye;
+	  return matches;
+	}
+      }
+      continue;
+
+    case SSCANF_OP_STRING:
+      if (!op->no_assign) {
+	SET_SVAL(sval, T_STRING, 0, string,
+		 get_string_slice(input, 0, eye, input_len - eye, pstr));
+      }
+      eye = input_len;
+      break;
+
+    case SSCANF_OP_STRING_TO:
+      {
+	struct pike_mem_searcher searcher;
+	p_wchar0 *s2;
+	pike_init_memsearch(&searcher, MKPCHARP(match + op->pos, 0),
+			    op->len, input_len - eye);
+	s2 = searcher.mojt.vtab->func0(searcher.mojt.data, input + eye,
+				       input_len - eye);
+	if (!s2) {
+	  chars_matched[0] = eye;
+	  return matches;
+	}
+	if (!op->no_assign) {
+	  SET_SVAL(sval, T_STRING, 0, string,
+		   get_string_slice(input, 0, eye, (s2 - input) - eye, pstr));
+	}
+	eye = (s2 - input) + op->len;
+      }
+      break;
+
+    case SSCANF_OP_INT:
+      {
+	p_wchar0 *t;
+	if (eye >= input_len) {
+	  chars_matched[0] = eye;
+	  return matches;
+	}
+	wide_string_to_svalue_inumber(&sval, input + eye, &t, 10, -1, 0);
+	if (input + eye == t) {
+	  chars_matched[0] = eye;
+	  return matches;
+	}
+	eye = t - input;
+      }
+      break;
+
+    case SSCANF_OP_CHAR:
+      if (eye >= input_len) {
+	chars_matched[0] = eye;
+	return matches;
+      }
+      SET_SVAL(sval, T_INT, NUMBER_NUMBER, integer, input[eye]);
+      eye++;
+      break;
+
+    case SSCANF_OP_FLOAT:
+      {
+	PCHARP t;
+	FLOAT_TYPE f;
+	if (eye >= input_len) {
+	  chars_matched[0] = eye;
+	  return matches;
+	}
+	f = (FLOAT_TYPE)STRTOFLOAT_PCHARP(MKPCHARP(input + eye, 0), &t);
+	if (input + eye == (p_wchar0 *)t.ptr) {
+	  chars_matched[0] = eye;
+	  return matches;
+	}
+	eye = (p_wchar0 *)t.ptr - input;
+	SET_SVAL(sval, T_FLOAT, 0, float_number, f);
+      }
+      break;
+    }
+
+    matches++;
+    if (op->no_assign) {
+      if (op->kind == SSCANF_OP_INT) free_svalue(&sval);
+    } else {
+      check_stack(1);
+      *Pike_sp++ = sval;
+      dmalloc_touch_svalue(Pike_sp-1);
+    }
+  }
+  chars_matched[0] = eye;
+  return matches;
+}
+
+void exit_sscanf(void)
+{
+  int i;
+  for (i = 0; i < SSCANF_CACHE_SIZE; i++) {
+    struct sscanf_program *prog = sscanf_cache[i];
+    if (!prog) continue;
+    free_string(prog->format);
+    free(prog);
+    sscanf_cache[i] = NULL;
+  }
+}
+
 /* */
 INT32 low_sscanf_pcharp(PCHARP input, ptrdiff_t len,
                         PCHARP format, ptrdiff_t format_len,
@@ -1574,6 +1836,24 @@ INT32 low_sscanf_pcharp(PCHARP input, ptrdiff_t len,
   UNREACHABLE();
 }
 
+/* Same as low_sscanf_pcharp(), but with the format as a string,
+ * which allows compiled formats to be used.
+ */
+INT32 low_sscanf_pcharp_str(PCHARP input, ptrdiff_t len,
+			    struct pike_string *format,
+			    ptrdiff_t *chars_matched, int flags)
+{
+  if (!input.shift) {
+    struct sscanf_program *prog = get_sscanf_program(format);
+    if (prog)
+      return run_sscanf_program(prog, input.ptr, len, STR0(format),
+				chars_matched, NULL);
+  }
+  return low_sscanf_pcharp(input, len,
+			   MKPCHARP(format->str, format->size_shift),
+			   format->len, chars_matched, flags);
+}
+
 /* Simplified interface to very_low_sscanf_{0,1,2}_{0,1,2}(). */
 INT32 low_sscanf(struct pike_string *data, struct pike_string *format,
 		 INT32 flags)
@@ -1581,6 +1861,13 @@ INT32 low_sscanf(struct pike_string *data, struct pike_string *format,
   ptrdiff_t matched_chars;
   int x;
 
+  if (!data->size_shift) {
+    struct sscanf_program *prog = get_sscanf_program(format);
+    if (prog)
+      return run_sscanf_program(prog, STR0(data), data->len, STR0(format),
+				&matched_chars, data);
+  }
+
   check_c_stack(sizeof(struct sscanf_set)*2 + 512);
 
   switch(data->size_shift*3 + format->size_shift) {
@@ -13,6 +13,10 @@ INT32 low_sscanf_pcharp(PCHARP input, ptrdiff_t len,
                         PCHARP format, ptrdiff_t format_len,
                         ptrdiff_t *chars_matched, int flags);
 
+INT32 low_sscanf_pcharp_str(PCHARP input, ptrdiff_t len,
+			    struct pike_string *format,
+			    ptrdiff_t *chars_matched, int flags);
+
 INT32 low_sscanf(struct pike_string *data, struct pike_string *format,
 		 INT32 flags);
 void o_sscanf(INT32 args);
@@ -20,5 +24,6 @@ void o_sscanf_80(INT32 args);
 PMOD_EXPORT void f_sscanf(INT32 args);
 PMOD_EXPORT void f_sscanf_80(INT32 args);
 void f___handle_sscanf_format(INT32 args);
+void exit_sscanf(void);
 
 #endif
@@ -1628,8 +1628,11 @@ PMOD_EXPORT ptrdiff_t my_quick_strcmp(const struct pike_string *a,
 }
 
 
-struct pike_string *realloc_unlinked_string(struct pike_string *a,
-                                           ptrdiff_t size)
+/* If slack is set and the string is growing, some extra space may be
+ * allocated at the end, for use by later calls. */
+static struct pike_string *low_realloc_unlinked_string(struct pike_string *a,
+                                                       ptrdiff_t size,
+                                                       int slack)
 {
   char * s = NULL;
   size_t nbytes = (size_t)(size+1) << a->size_shift;
@@ -1649,6 +1652,21 @@ struct pike_string *realloc_unlinked_string(struct pike_string *a,
   }
   else if( a->alloc_type == STRING_ALLOC_MALLOC)
   {
+#if defined(HAVE_MALLOC_USABLE_SIZE) && !defined(DEBUG_MALLOC) && \
+    !defined(USE_DL_MALLOC)
+    /* NB: With USE_DL_MALLOC the block comes from dlmalloc, which
+     *     malloc_usable_size() in libc knows nothing about. */
+    if (slack && (size > a->len)) {
+      /* The string is growing, which is what happens when appending
+       * to a string with a single reference (eg str += foo). Keep
+       * some slack at the end so that repeated appends are linear,
+       * rather than depending on realloc() growing the block in place.
+       */
+      if (nbytes <= malloc_usable_size(a->str))
+        goto done;
+      nbytes += nbytes >> 1;
+    }
+#endif
     s = xrealloc(a->str,nbytes);
   }
   else
@@ -1666,6 +1684,15 @@ done:
   return a;
 }
 
+/* NB: Allocates exactly the requested size, since the string builder
+ *     handles its own slack, and trims it in finish_string_builder().
+ */
+struct pike_string *realloc_unlinked_string(struct pike_string *a,
+                                           ptrdiff_t size)
+{
+  return low_realloc_unlinked_string(a, size, 0);
+}
+
 
 /* Returns an unlinked string ready for end_shared_string */
 static struct pike_string *realloc_shared_string(struct pike_string *a,
@@ -1674,7 +1701,7 @@ static struct pike_string *realloc_shared_string(struct pike_string *a,
   if(string_may_modify_len(a))
   {
     unlink_pike_string(a);
-    return realloc_unlinked_string(a, size);
+    return low_realloc_unlinked_string(a, size, 1);
   }else{
     struct pike_string *r=begin_wide_shared_string(size,a->size_shift);
     memcpy(r->str, a->str, a->len<<a->size_shift);
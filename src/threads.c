@@ -4256,7 +4256,6 @@ static struct farmer *new_farmer(void (*fun)(void *), void *args)
 
   dmalloc_accept_leak(me);
 
-  _num_farmers++;
   me->neighbour = 0;
   me->field = args;
   me->harvest = fun;
@@ -4287,6 +4286,8 @@ PMOD_EXPORT void th_farm(void (*fun)(void *), void *here)
     co_signal( &f->harvest_moon );
     return;
   }
+  /* NB: th_farm() may be called without the interpreter lock. */
+  _num_farmers++;
   mt_unlock( &rosie );
   new_farmer( fun, here );
 }